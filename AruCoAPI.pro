@@ -11,12 +11,17 @@ CONFIG += c++17
 
 SOURCES += \
     arucoapi.cpp \
+    detectionpublisher.cpp \
     markerthread.cpp \
     yamlhandler.cpp
 
 HEADERS += \
     TestLib_global.h \
     arucoapi.h \
+    blockgeometry.h \
+    detectionpublisher.h \
+    ipcschema.h \
+    ipcsubscriber.h \
     markerthread.h \
     yamlhandler.h
 
@@ -5,6 +5,7 @@ AruCoAPI::AruCoAPI(QObject *parent)
     : QObject{parent}
     , yamlHandler(new YamlHandler(this))
     , markerThread(new MarkerThread())
+    , publisher(new DetectionPublisher(this))
     , calibrationStatus(false)
 {
     connect(markerThread, &MarkerThread::frameReady, this, &AruCoAPI::frameReady);
@@ -18,6 +19,7 @@ AruCoAPI::AruCoAPI(QObject *parent)
 AruCoAPI::~AruCoAPI()
 {
     stopThread(markerThread);
+    stopPublishing();
 }
 
 void AruCoAPI::init()
@@ -29,6 +31,7 @@ void AruCoAPI::init()
     }
     markerThread->setCalibrationParams(calibrationParams);
     markerThread->setYamlHandler(yamlHandler);
+    markerThread->updateConfigurationsMap();
     startThread(markerThread);
     qDebug() << "THREAD STARTED";
 }
@@ -69,3 +72,35 @@ void AruCoAPI::detectMarkerBlocks(bool status)
         }
     }
 }
+
+bool AruCoAPI::startPublishing(const QString &key)
+{
+    if (publisher->isActive()) {
+        if (publisher->key() == key) {
+            return true;
+        }
+        emit taskFinished(
+            false,
+            tr("Already publishing to %1, stop publishing before switching to %2")
+                .arg(publisher->key(), key));
+        return false;
+    }
+    if (!publisher->start(key)) {
+        emit taskFinished(
+            false, tr("Failed to start publishing: %1").arg(publisher->errorString()));
+        return false;
+    }
+    markerThread->setPublisher(publisher);
+    emit taskChanged(tr("Publishing started"));
+    return true;
+}
+
+void AruCoAPI::stopPublishing()
+{
+    if (!publisher->isActive()) {
+        return;
+    }
+    markerThread->setPublisher(nullptr);
+    publisher->stop();
+    emit taskChanged(tr("Publishing stopped"));
+}
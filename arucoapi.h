@@ -2,6 +2,7 @@
 #define TESTLIB_H
 
 #include "AruCoAPI_global.h"
+#include "detectionpublisher.h"
 #include "markerthread.h"
 #include "yamlhandler.h"
 #include <opencv2/opencv.hpp>
@@ -29,10 +30,13 @@ signals:
 
 public slots:
     void detectMarkerBlocks(bool status); // Starts and ends block detection task
+    bool startPublishing(const QString &key); // Streams detections to shared memory segment
+    void stopPublishing();
 
 private:
     YamlHandler *yamlHandler;
     MarkerThread *markerThread;
+    DetectionPublisher *publisher;
 
     CalibrationParams calibrationParams;
     bool calibrationStatus;
@@ -0,0 +1,165 @@
+// Microbenchmark of per-frame block geometry in MarkerThread: the former cv::Mat based path
+// against the current cv::Matx33d/cv::Vec3d path from blockgeometry.h. Both compute marker rotation matrices, yaw
+// angles and weighted block center for the same random poses, results are checked to match.
+
+#include "blockgeometry.h"
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int kMarkers = 8;
+constexpr int kFrames = 20000;
+
+struct Frame
+{
+    std::vector<cv::Vec3d> rvecs;
+    std::vector<cv::Vec3d> tvecs;
+    std::vector<cv::Point3f> relativePoints;
+};
+
+struct Result
+{
+    std::vector<cv::Matx33d> rotations;
+    std::vector<float> yaws;
+    cv::Point3f center;
+};
+
+float yawFromRotation(double r10, double r00)
+{
+    float yaw = atan2(r10, r00) * (180.0 / CV_PI);
+    if (yaw < 0) {
+        yaw += 360.0f;
+    }
+    return yaw;
+}
+
+// Path used before switching to fixed-size types
+void matPath(const Frame &frame, Result &result)
+{
+    result.rotations.clear();
+    result.yaws.clear();
+    std::vector<cv::Point3f> allPoints;
+    std::vector<float> reprojectionErrors;
+
+    for (int i = 0; i < kMarkers; i++) {
+        cv::Mat rotationMatrix;
+        cv::Rodrigues(frame.rvecs[i], rotationMatrix);
+        result.rotations.push_back(cv::Matx33d(rotationMatrix));
+        result.yaws.push_back(
+            yawFromRotation(rotationMatrix.at<double>(1, 0), rotationMatrix.at<double>(0, 0)));
+    }
+
+    for (int i = 0; i < kMarkers; i++) {
+        cv::Mat rotationMatrix;
+        cv::Rodrigues(frame.rvecs[i], rotationMatrix);
+
+        cv::Mat relativePointMat
+            = (cv::Mat_<double>(3, 1) << frame.relativePoints[i].x,
+               frame.relativePoints[i].y,
+               frame.relativePoints[i].z);
+        cv::Mat newPointMat = rotationMatrix * relativePointMat + cv::Mat(frame.tvecs[i]);
+
+        float error = cv::norm(relativePointMat - newPointMat);
+
+        allPoints.push_back(cv::Point3f(
+            newPointMat.at<double>(0), newPointMat.at<double>(1), newPointMat.at<double>(2)));
+        reprojectionErrors.push_back(error);
+    }
+
+    cv::Point3f weightedSum(0, 0, 0);
+    float totalWeight = 0.0f;
+    for (size_t i = 0; i < allPoints.size(); i++) {
+        float weight = 1.0f / (reprojectionErrors[i] + 1e-5);
+        weightedSum += allPoints[i] * weight;
+        totalWeight += weight;
+    }
+    result.center = weightedSum / totalWeight;
+}
+
+// Path used by MarkerThread, scratch buffers are reused between frames as there
+void matxPath(const Frame &frame, Result &result, std::vector<cv::Vec3d> &relativePoints)
+{
+    result.rotations.resize(kMarkers);
+    result.yaws.clear();
+    relativePoints.clear();
+
+    for (int i = 0; i < kMarkers; i++) {
+        cv::Rodrigues(frame.rvecs[i], result.rotations[i]);
+        result.yaws.push_back(markerYaw(result.rotations[i]));
+
+        const cv::Point3f &relativePoint = frame.relativePoints[i];
+        relativePoints.push_back(cv::Vec3d(relativePoint.x, relativePoint.y, relativePoint.z));
+    }
+
+    result.center = blockCenter(result.rotations, frame.tvecs, relativePoints);
+}
+
+bool sameResult(const Result &a, const Result &b)
+{
+    for (int i = 0; i < kMarkers; i++) {
+        if (cv::norm(a.rotations[i], b.rotations[i], cv::NORM_INF) > 1e-12) {
+            return false;
+        }
+        if (std::abs(a.yaws[i] - b.yaws[i]) > 1e-3f) {
+            return false;
+        }
+    }
+    // Former path accumulates in float, center is compared with 1 um tolerance in mm units
+    return cv::norm(a.center - b.center) < 1e-3;
+}
+
+} // namespace
+
+int main()
+{
+    cv::RNG rng(42);
+    std::vector<Frame> frames(kFrames);
+    for (Frame &frame : frames) {
+        for (int i = 0; i < kMarkers; i++) {
+            frame.rvecs.push_back(cv::Vec3d(
+                rng.uniform(-CV_PI, CV_PI), rng.uniform(-CV_PI, CV_PI), rng.uniform(-CV_PI, CV_PI)));
+            frame.tvecs.push_back(cv::Vec3d(
+                rng.uniform(-200.0, 200.0), rng.uniform(-200.0, 200.0), rng.uniform(200.0, 1000.0)));
+            frame.relativePoints.push_back(cv::Point3f(
+                rng.uniform(-100.f, 100.f), rng.uniform(-100.f, 100.f), rng.uniform(-20.f, 20.f)));
+        }
+    }
+
+    Result matResult, matxResult;
+    std::vector<cv::Vec3d> relativePoints;
+
+    for (const Frame &frame : frames) {
+        matPath(frame, matResult);
+        matxPath(frame, matxResult, relativePoints);
+        if (!sameResult(matResult, matxResult)) {
+            std::printf("Results of cv::Mat and cv::Matx paths differ\n");
+            return 1;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    float sink = 0.0f;
+
+    auto start = Clock::now();
+    for (const Frame &frame : frames) {
+        matPath(frame, matResult);
+        sink += matResult.center.x;
+    }
+    double matTime = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (const Frame &frame : frames) {
+        matxPath(frame, matxResult, relativePoints);
+        sink += matxResult.center.x;
+    }
+    double matxTime = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    std::printf("%d frames, %d markers per frame (checksum %f)\n", kFrames, kMarkers, sink);
+    std::printf("cv::Mat path:  %8.3f us/frame\n", matTime / kFrames);
+    std::printf("cv::Matx path: %8.3f us/frame\n", matxTime / kFrames);
+    std::printf("speedup:       %8.2fx\n", matTime / matxTime);
+    return 0;
+}
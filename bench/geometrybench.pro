@@ -0,0 +1,22 @@
+QT -= core gui
+
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+TARGET = geometrybench
+
+SOURCES += \
+    geometrybench.cpp
+
+HEADERS += \
+    ../blockgeometry.h
+
+INCLUDEPATH += $$PWD/..
+
+# OPENCV
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../third_party/opencv_mingw810/x64/mingw/bin/ -llibopencv_world4100
+else:unix: LIBS += -L$$PWD/../third_party/opencv_mingw810/x64/mingw/lib/ -llibopencv_world4100
+
+INCLUDEPATH += $$PWD/../third_party/opencv_mingw810/include
+DEPENDPATH += $$PWD/../third_party/opencv_mingw810/include
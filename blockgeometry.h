@@ -0,0 +1,43 @@
+#ifndef BLOCKGEOMETRY_H
+#define BLOCKGEOMETRY_H
+
+// Per-frame block geometry used by MarkerThread, kept free of Qt so bench/ can use it directly
+
+#include <opencv2/core.hpp>
+#include <cmath>
+#include <vector>
+
+// Yaw angle of marker in degrees normalized to [0, 360)
+inline float markerYaw(const cv::Matx33d &rotation)
+{
+    float yaw = atan2(rotation(1, 0), rotation(0, 0)) * (180.0 / CV_PI);
+    if (yaw < 0) {
+        yaw += 360.0f;
+    }
+    return yaw;
+}
+
+// Transforms relative point of each block marker by its pose and returns weighted average of
+// results, weight is inverse of distance between relative and transformed point.
+// All vectors must have the same non-zero size.
+inline cv::Point3f blockCenter(
+    const std::vector<cv::Matx33d> &rotations,
+    const std::vector<cv::Vec3d> &tvecs,
+    const std::vector<cv::Vec3d> &relativePoints)
+{
+    cv::Vec3d weightedSum(0, 0, 0);
+    double totalWeight = 0.0;
+
+    for (size_t i = 0; i < relativePoints.size(); i++) {
+        cv::Vec3d newPoint = rotations[i] * relativePoints[i] + tvecs[i];
+        double error = cv::norm(relativePoints[i] - newPoint);
+        double weight = 1.0 / (error + 1e-5);
+        weightedSum += newPoint * weight;
+        totalWeight += weight;
+    }
+
+    weightedSum /= totalWeight;
+    return cv::Point3f(weightedSum[0], weightedSum[1], weightedSum[2]);
+}
+
+#endif // BLOCKGEOMETRY_H
@@ -0,0 +1,158 @@
+#include "detectionpublisher.h"
+#include <QDateTime>
+#include <QDebug>
+#include <climits>
+#include <cstring>
+#include <new>
+
+namespace {
+
+void copyString(char *dst, size_t size, const std::string &src)
+{
+    size_t length = std::min(size - 1, src.size());
+    std::memcpy(dst, src.data(), length);
+    dst[length] = '\0';
+}
+
+} // namespace
+
+DetectionPublisher::DetectionPublisher(QObject *parent)
+    : QObject(parent)
+    , header(nullptr)
+    , blockSequence(0)
+    , frameSequence(0)
+    , frameDropReported(false)
+{}
+
+DetectionPublisher::~DetectionPublisher()
+{
+    stop();
+}
+
+bool DetectionPublisher::start(
+    const QString &key, uint32_t blockCapacity, uint32_t frameSlotCount, uint32_t frameSlotSize)
+{
+    if (isActive()) {
+        lastError = tr("Publisher is already running");
+        return false;
+    }
+    if (key.isEmpty()) {
+        lastError = tr("Shared memory key is empty");
+        return false;
+    }
+    if (blockCapacity == 0 || frameSlotCount == 0) {
+        lastError = tr("Block capacity and frame slot count must be positive");
+        return false;
+    }
+    if (frameSlotSize < kIpcPreviewFrameSize) {
+        lastError = tr("Frame slot size %1 is smaller than preview frame size %2")
+                        .arg(frameSlotSize)
+                        .arg(kIpcPreviewFrameSize);
+        return false;
+    }
+    size_t segmentSize = ipcSegmentSize(blockCapacity, frameSlotCount, frameSlotSize);
+    if (segmentSize > size_t(INT_MAX)) {
+        lastError = tr("Shared memory segment of %1 bytes is too large").arg(segmentSize);
+        return false;
+    }
+    int size = (int) segmentSize;
+
+    sharedMemory.setNativeKey(key);
+    if (!sharedMemory.create(size)) {
+        // Segment may be left over from a crashed process, attaching and detaching releases it.
+        // Attached subscribers keep it alive, see ipcschema.h.
+        if (sharedMemory.error() != QSharedMemory::AlreadyExists || !sharedMemory.attach()
+            || !sharedMemory.detach() || !sharedMemory.create(size)) {
+            lastError = tr("%1 (segment %2 may still be attached by subscribers)")
+                            .arg(sharedMemory.errorString(), key);
+            return false;
+        }
+    }
+
+    std::memset(sharedMemory.data(), 0, size);
+    header = new (sharedMemory.data()) IpcHeader{};
+    header->version = kIpcVersion;
+    header->blockCapacity = blockCapacity;
+    header->frameSlotCount = frameSlotCount;
+    header->frameSlotSize = frameSlotSize;
+    blockSequence = 0;
+    frameSequence = 0;
+    frameDropReported = false;
+
+    header->magic.store(kIpcMagic, std::memory_order_release);
+    activeKey = key;
+    lastError.clear();
+    return true;
+}
+
+void DetectionPublisher::stop()
+{
+    if (!isActive()) {
+        return;
+    }
+    header->magic.store(0, std::memory_order_release);
+    header = nullptr;
+    activeKey.clear();
+    sharedMemory.detach();
+}
+
+void DetectionPublisher::publishBlock(const MarkerBlock &block)
+{
+    if (!isActive()) {
+        return;
+    }
+
+    uint64_t sequence = ++blockSequence;
+    IpcBlockRecord *record = ipcBlockRecord(header, sequence);
+
+    record->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record->timestampMs = QDateTime::currentMSecsSinceEpoch();
+    record->centerX = block.blockCenter.x();
+    record->centerY = block.blockCenter.y();
+    record->distanceToCenter = block.distanceToCenter;
+    record->blockAngle = block.blockAngle;
+    copyString(record->configId, sizeof(record->configId), block.config.id);
+    copyString(record->configName, sizeof(record->configName), block.config.name);
+
+    record->sequence.store(sequence, std::memory_order_release);
+    header->blockSequence.store(sequence, std::memory_order_release);
+}
+
+void DetectionPublisher::publishFrame(const cv::Mat &frame)
+{
+    if (!isActive() || frame.empty()) {
+        return;
+    }
+
+    size_t rowSize = frame.cols * frame.elemSize();
+    if (rowSize * frame.rows > header->frameSlotSize) {
+        header->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        if (!frameDropReported) {
+            qWarning() << "Frame of" << frame.cols << "x" << frame.rows
+                       << "does not fit shared memory frame slot, dropping it";
+            frameDropReported = true;
+        }
+        return;
+    }
+
+    uint64_t sequence = ++frameSequence;
+    IpcFrameSlot *slot = ipcFrameSlot(header, sequence);
+
+    slot->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->timestampMs = QDateTime::currentMSecsSinceEpoch();
+    slot->width = frame.cols;
+    slot->height = frame.rows;
+    slot->step = (int32_t) rowSize;
+    slot->type = frame.type();
+
+    // Copy straight into the slot, subscribers read pixel data in place
+    cv::Mat slotFrame(frame.rows, frame.cols, frame.type(), ipcFrameData(slot), rowSize);
+    frame.copyTo(slotFrame);
+
+    slot->sequence.store(sequence, std::memory_order_release);
+    header->frameSequence.store(sequence, std::memory_order_release);
+}
@@ -0,0 +1,43 @@
+#ifndef DETECTIONPUBLISHER_H
+#define DETECTIONPUBLISHER_H
+
+#include "ipcschema.h"
+#include "markerthread.h"
+#include <opencv2/opencv.hpp>
+#include <QObject>
+#include <QSharedMemory>
+
+// Publishes detected blocks and preview frames to a shared memory segment (see ipcschema.h),
+// so that other local processes can consume them without linking this library.
+// publishBlock and publishFrame are called from MarkerThread, start and stop from the owner thread.
+class DetectionPublisher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DetectionPublisher(QObject *parent = nullptr);
+    ~DetectionPublisher();
+
+    bool start(
+        const QString &key,
+        uint32_t blockCapacity = kIpcDefaultBlockCapacity,
+        uint32_t frameSlotCount = kIpcDefaultFrameSlotCount,
+        uint32_t frameSlotSize = kIpcDefaultFrameSlotSize);
+    void stop();
+    bool isActive() const { return header != nullptr; }
+    QString key() const { return activeKey; }
+    QString errorString() const { return lastError; }
+
+    void publishBlock(const MarkerBlock &block);
+    void publishFrame(const cv::Mat &frame);
+
+private:
+    QSharedMemory sharedMemory;
+    QString lastError;
+    QString activeKey;
+    bool frameDropReported;
+    IpcHeader *header;
+    uint64_t blockSequence;
+    uint64_t frameSequence;
+};
+
+#endif // DETECTIONPUBLISHER_H
@@ -0,0 +1,179 @@
+#ifndef IPCSCHEMA_H
+#define IPCSCHEMA_H
+
+// Layout of the shared memory segment written by DetectionPublisher.
+// This header has no Qt or OpenCV dependencies so subscriber processes can include it directly,
+// ipcsubscriber.h adds Qt-free helpers to attach to the segment.
+//
+// Segment: IpcHeader | IpcBlockRecord[blockCapacity] | (IpcFrameSlot + pixel data)[frameSlotCount]
+//
+// Opening the segment, key is the one passed to AruCoAPI::startPublishing:
+//  - Windows: named file mapping, OpenFileMappingW(FILE_MAP_READ, FALSE, key) + MapViewOfFile.
+//  - Unix, Qt built with System V IPC (Qt5 default): key is a path to a file created by the
+//    publisher, segment id is shmget(ftok(key, 'Q'), 0, 0), map it with shmat(id, 0, SHM_RDONLY).
+//    Use an absolute path such as "/tmp/arucoapi" as key.
+//  - Unix, Qt built with QT_POSIX_IPC: shm_open(key, O_RDONLY, 0), size from fstat, then mmap.
+//    Key must start with '/', e.g. "/arucoapi".
+// Segment is created with owner-only permissions (0600 on Unix, default security descriptor of
+// publisher process on Windows), so subscribers must run as the same user as the publisher.
+//
+// Reading:
+//  - Check ipcIsValid before use. Publisher sets magic to 0 when it stops, subscribers must then
+//    detach, otherwise on System V the publisher cannot create the segment again with the same key.
+//  - Sequence numbers start at 1, record with sequence N lives at index N % capacity.
+//    IpcHeader::blockSequence and frameSequence hold the last published sequence, frames too large
+//    for a slot are not published and counted in droppedFrames.
+//  - Each record and frame slot is guarded by its own sequence field (seqlock): publisher sets it
+//    to 0 while writing and to the record's sequence once done. Use ipcTryReadBlock for blocks and
+//    ipcBeginReadFrame/ipcEndReadFrame around in-place reads of frames, they issue the loads and
+//    fences needed on weakly ordered CPUs. A failed read of sequence N while the header sequence is
+//    at least N + capacity means the reader has been overrun.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+constexpr uint32_t kIpcMagic = 0x43555241; // "ARUC"
+constexpr uint32_t kIpcVersion = 1;
+
+constexpr uint32_t kIpcDefaultBlockCapacity = 256;
+constexpr uint32_t kIpcDefaultFrameSlotCount = 4;
+constexpr uint32_t kIpcPreviewFrameSize = 640 * 480 * 3; // 640x480 BGR preview of MarkerThread
+constexpr uint32_t kIpcDefaultFrameSlotSize = kIpcPreviewFrameSize;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared atomics must be lock free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared atomics must be lock free");
+
+struct alignas(64) IpcHeader
+{
+    std::atomic<uint32_t> magic; // kIpcMagic while publishing, 0 once publisher stopped
+    uint32_t version;            // kIpcVersion
+    uint32_t blockCapacity;      // Number of IpcBlockRecord entries in ring buffer
+    uint32_t frameSlotCount;     // Number of frame slots in frame pool
+    uint32_t frameSlotSize;      // Maximum pixel data size of one frame slot in bytes
+    uint32_t reserved;
+    std::atomic<uint64_t> blockSequence; // Sequence of last published block, 0 if none
+    std::atomic<uint64_t> frameSequence; // Sequence of last published frame, 0 if none
+    std::atomic<uint64_t> droppedFrames; // Frames skipped because they did not fit a frame slot
+};
+
+struct alignas(64) IpcBlockRecord
+{
+    std::atomic<uint64_t> sequence;
+    int64_t timestampMs; // Milliseconds since epoch
+    float centerX;
+    float centerY;
+    float distanceToCenter;
+    float blockAngle;
+    char configId[32];   // Null terminated, truncated if longer
+    char configName[64]; // Null terminated, truncated if longer
+};
+
+struct alignas(64) IpcFrameSlot
+{
+    std::atomic<uint64_t> sequence;
+    int64_t timestampMs; // Milliseconds since epoch
+    int32_t width;
+    int32_t height;
+    int32_t step; // Bytes per row
+    int32_t type; // OpenCV matrix type, CV_8UC3 (BGR) for preview frames
+};
+
+inline size_t ipcFrameSlotStride(uint32_t frameSlotSize)
+{
+    return (sizeof(IpcFrameSlot) + size_t(frameSlotSize) + 63) & ~size_t(63);
+}
+
+inline size_t ipcSegmentSize(uint32_t blockCapacity, uint32_t frameSlotCount, uint32_t frameSlotSize)
+{
+    return sizeof(IpcHeader) + size_t(blockCapacity) * sizeof(IpcBlockRecord)
+           + size_t(frameSlotCount) * ipcFrameSlotStride(frameSlotSize);
+}
+
+inline bool ipcIsValid(const IpcHeader *header)
+{
+    return header && header->magic.load(std::memory_order_acquire) == kIpcMagic
+           && header->version == kIpcVersion;
+}
+
+inline IpcBlockRecord *ipcBlockRecord(IpcHeader *header, uint64_t sequence)
+{
+    auto *records = reinterpret_cast<IpcBlockRecord *>(header + 1);
+    return &records[sequence % header->blockCapacity];
+}
+
+inline const IpcBlockRecord *ipcBlockRecord(const IpcHeader *header, uint64_t sequence)
+{
+    return ipcBlockRecord(const_cast<IpcHeader *>(header), sequence);
+}
+
+inline IpcFrameSlot *ipcFrameSlot(IpcHeader *header, uint64_t sequence)
+{
+    auto *pool = reinterpret_cast<unsigned char *>(header + 1)
+                 + size_t(header->blockCapacity) * sizeof(IpcBlockRecord);
+    size_t index = sequence % header->frameSlotCount;
+    return reinterpret_cast<IpcFrameSlot *>(pool + index * ipcFrameSlotStride(header->frameSlotSize));
+}
+
+inline const IpcFrameSlot *ipcFrameSlot(const IpcHeader *header, uint64_t sequence)
+{
+    return ipcFrameSlot(const_cast<IpcHeader *>(header), sequence);
+}
+
+inline unsigned char *ipcFrameData(IpcFrameSlot *slot)
+{
+    return reinterpret_cast<unsigned char *>(slot + 1);
+}
+
+inline const unsigned char *ipcFrameData(const IpcFrameSlot *slot)
+{
+    return reinterpret_cast<const unsigned char *>(slot + 1);
+}
+
+// Copies block record with given sequence, returns false if it is not published yet,
+// being written or already overwritten
+inline bool ipcTryReadBlock(const IpcHeader *header, uint64_t sequence, IpcBlockRecord &out)
+{
+    const IpcBlockRecord *record = ipcBlockRecord(header, sequence);
+    if (record->sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+
+    out.timestampMs = record->timestampMs;
+    out.centerX = record->centerX;
+    out.centerY = record->centerY;
+    out.distanceToCenter = record->distanceToCenter;
+    out.blockAngle = record->blockAngle;
+    std::memcpy(out.configId, record->configId, sizeof(out.configId));
+    std::memcpy(out.configName, record->configName, sizeof(out.configName));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (record->sequence.load(std::memory_order_relaxed) != sequence) {
+        return false;
+    }
+    out.configId[sizeof(out.configId) - 1] = '\0';
+    out.configName[sizeof(out.configName) - 1] = '\0';
+    out.sequence.store(sequence, std::memory_order_relaxed);
+    return true;
+}
+
+// Returns frame slot holding given sequence or nullptr if it is not available.
+// Slot fields and pixel data may be read in place until ipcEndReadFrame, results are only
+// valid if ipcEndReadFrame returns true.
+inline const IpcFrameSlot *ipcBeginReadFrame(const IpcHeader *header, uint64_t sequence)
+{
+    const IpcFrameSlot *slot = ipcFrameSlot(header, sequence);
+    if (slot->sequence.load(std::memory_order_acquire) != sequence) {
+        return nullptr;
+    }
+    return slot;
+}
+
+inline bool ipcEndReadFrame(const IpcFrameSlot *slot, uint64_t sequence)
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+#endif // IPCSCHEMA_H
@@ -0,0 +1,127 @@
+#ifndef IPCSUBSCRIBER_H
+#define IPCSUBSCRIBER_H
+
+// Qt-free helpers for subscriber processes to attach to the segment written by DetectionPublisher.
+// Not used by the library itself. Define ARUCOAPI_IPC_POSIX on Unix if the library's Qt was built
+// with QT_POSIX_IPC, otherwise System V shared memory is used as in Qt5 by default.
+//
+// Usage:
+//     IpcSegment segment;
+//     if (ipcAttach("/tmp/arucoapi", segment)) {
+//         uint64_t next = segment.header->blockSequence.load(std::memory_order_acquire) + 1;
+//         IpcBlockRecord block;
+//         while (ipcIsValid(segment.header)) {
+//             if (ipcTryReadBlock(segment.header, next, block)) {
+//                 ... use block ...
+//                 next++;
+//             }
+//         }
+//         ipcDetach(segment);
+//     }
+
+#include "ipcschema.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(ARUCOAPI_IPC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+struct IpcSegment
+{
+    const IpcHeader *header = nullptr;
+    size_t size = 0;
+};
+
+inline void ipcDetach(IpcSegment &segment)
+{
+    if (!segment.header) {
+        return;
+    }
+    void *data = const_cast<IpcHeader *>(segment.header);
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+#elif defined(ARUCOAPI_IPC_POSIX)
+    munmap(data, segment.size);
+#else
+    shmdt(data);
+#endif
+    segment.header = nullptr;
+    segment.size = 0;
+}
+
+// Maps segment read-only, fails if publisher is not running or segment has unexpected layout
+inline bool ipcAttach(const char *key, IpcSegment &segment)
+{
+    void *data = nullptr;
+    size_t size = 0;
+
+#if defined(_WIN32)
+    // Qt passes key as UTF-16, ANSI name matches it for ASCII keys
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, key);
+    if (!mapping) {
+        return false;
+    }
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        return false;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    if (VirtualQuery(data, &info, sizeof(info))) {
+        size = info.RegionSize;
+    }
+#elif defined(ARUCOAPI_IPC_POSIX)
+    int fd = shm_open(key, O_RDONLY, 0);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        size = size_t(info.st_size);
+        data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (!data || data == MAP_FAILED) {
+        return false;
+    }
+#else
+    key_t ipcKey = ftok(key, 'Q');
+    if (ipcKey == -1) {
+        return false;
+    }
+    int id = shmget(ipcKey, 0, 0);
+    if (id == -1) {
+        return false;
+    }
+    struct shmid_ds info;
+    if (shmctl(id, IPC_STAT, &info) == -1) {
+        return false;
+    }
+    size = info.shm_segsz;
+    data = shmat(id, nullptr, SHM_RDONLY);
+    if (data == (void *) -1) {
+        return false;
+    }
+#endif
+
+    segment.header = static_cast<const IpcHeader *>(data);
+    segment.size = size;
+
+    const IpcHeader *header = segment.header;
+    if (size < sizeof(IpcHeader) || !ipcIsValid(header) || header->blockCapacity == 0
+        || header->frameSlotCount == 0
+        || size < ipcSegmentSize(header->blockCapacity, header->frameSlotCount, header->frameSlotSize)) {
+        ipcDetach(segment);
+        return false;
+    }
+    return true;
+}
+
+#endif // IPCSUBSCRIBER_H
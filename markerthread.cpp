@@ -1,9 +1,29 @@
 #include "markerthread.h"
+#include "blockgeometry.h"
+#include "detectionpublisher.h"
 #include <QDebug>
 #include <QPointF>
+#include <QStringList>
+
+namespace {
+
+// Corners of a square marker with given side length centered at origin
+cv::Mat makeObjectPoints(float size)
+{
+    cv::Mat points(4, 1, CV_32FC3);
+    points.ptr<cv::Vec3f>(0)[0] = cv::Vec3f(-size / 2.f, size / 2.f, 0);
+    points.ptr<cv::Vec3f>(0)[1] = cv::Vec3f(size / 2.f, size / 2.f, 0);
+    points.ptr<cv::Vec3f>(0)[2] = cv::Vec3f(size / 2.f, -size / 2.f, 0);
+    points.ptr<cv::Vec3f>(0)[3] = cv::Vec3f(-size / 2.f, -size / 2.f, 0);
+    return points;
+}
+
+} // namespace
 
 MarkerThread::MarkerThread(QObject *parent)
     : QThread{parent}
+    , yamlHandler(nullptr)
+    , publisher(nullptr)
     , running(false)
     , blockDetectionStatus(false)
     , markerSize(55.0f)
@@ -13,12 +33,27 @@ MarkerThread::MarkerThread(QObject *parent)
     AruCoDict = cv::aruco::getPredefinedDictionary(cv::aruco::DICT_6X6_250);
     detectorParams = cv::aruco::DetectorParameters();
     detector = cv::aruco::ArucoDetector(AruCoDict, detectorParams);
+}
+
+void MarkerThread::setMarkerSize(float newSize)
+{
+    if (newSize <= 0.0f) {
+        emit taskFinished(false, tr("Marker size must be positive, got %1").arg(newSize));
+        return;
+    }
+
+    QMutexLocker locker(&mutex);
+    markerSize = newSize;
+    std::vector<int> conflictingIds = rebuildObjectPoints();
+    locker.unlock();
 
-    objPoints = cv::Mat(4, 1, CV_32FC3);
-    objPoints.ptr<cv::Vec3f>(0)[0] = cv::Vec3f(-markerSize / 2.f, markerSize / 2.f, 0);
-    objPoints.ptr<cv::Vec3f>(0)[1] = cv::Vec3f(markerSize / 2.f, markerSize / 2.f, 0);
-    objPoints.ptr<cv::Vec3f>(0)[2] = cv::Vec3f(markerSize / 2.f, -markerSize / 2.f, 0);
-    objPoints.ptr<cv::Vec3f>(0)[3] = cv::Vec3f(-markerSize / 2.f, -markerSize / 2.f, 0);
+    reportMarkerSizeConflicts(conflictingIds);
+}
+
+void MarkerThread::setPublisher(DetectionPublisher *newPublisher)
+{
+    QMutexLocker locker(&mutex);
+    publisher = newPublisher;
 }
 
 void MarkerThread::stop()
@@ -57,6 +92,7 @@ void MarkerThread::run()
             markerPoints.clear();
             rvecs.clear();
             tvecs.clear();
+            rotations.clear();
 
             std::vector<std::vector<cv::Point2f>> markerCorners, rejectedCorners;
             detector.detectMarkers(resizedFrame, markerCorners, markerIds, rejectedCorners);
@@ -67,30 +103,20 @@ void MarkerThread::run()
                 int nMarkers = markerCorners.size();
                 rvecs.resize(nMarkers);
                 tvecs.resize(nMarkers);
-
-                std::vector<float> yaws{}; // Stores yaw angles of markers
+                rotations.resize(nMarkers);
+                yaws.clear();
 
                 for (size_t i = 0; i < nMarkers; i++) {
                     solvePnP(
-                        objPoints,
+                        getObjectPoints(markerIds.at(i)),
                         markerCorners.at(i),
                         calibrationParams.cameraMatrix,
                         calibrationParams.distCoeffs,
                         rvecs.at(i),
                         tvecs.at(i));
 
-                    cv::Mat rotationMatrix;
-                    cv::Rodrigues(rvecs.at(i), rotationMatrix);
-
-                    // Calculate yaw angle and normalize to [0, 360)
-                    float yaw
-                        = atan2(rotationMatrix.at<double>(1, 0), rotationMatrix.at<double>(0, 0))
-                          * (180.0 / CV_PI);
-                    if (yaw < 0) {
-                        yaw += 360.0f;
-                    }
-
-                    yaws.push_back(yaw);
+                    cv::Rodrigues(rvecs[i], rotations[i]);
+                    yaws.push_back(markerYaw(rotations[i]));
 
                     markerPoints.push_back(
                         std::make_pair(markerCorners[i][0], cv::Point3f(tvecs[i])));
@@ -128,11 +154,17 @@ void MarkerThread::run()
                         block.blockAngle = (yaws.size() % 2 == 0) ? (yaws[mid - 1] + yaws[mid]) / 2.0f
                                                                   : yaws[mid];
                     }
+                    if (publisher) {
+                        publisher->publishBlock(block);
+                    }
                     emit blockDetected(block);
                 } 
             } else {
                 detectCurrentConfiguration();
             }
+            if (publisher) {
+                publisher->publishFrame(resizedFrame);
+            }
             QImage
                 img(resizedFrame.data,
                     resizedFrame.cols,
@@ -149,9 +181,86 @@ void MarkerThread::run()
 
 void MarkerThread::updateConfigurationsMap()
 {
+    QMutexLocker locker(&mutex);
     configurations.clear();
     currentConfiguration.clear();
-    yamlHandler->loadConfigurations("configurations.yml", configurations);
+    if (yamlHandler) {
+        yamlHandler->loadConfigurations("configurations.yml", configurations);
+    }
+    std::vector<int> conflictingIds = rebuildObjectPoints();
+    locker.unlock();
+
+    reportMarkerSizeConflicts(conflictingIds);
+}
+
+// Must be called with mutex locked. Returns ids whose size differs between configurations if they
+// changed since last rebuild, such markers fall back to default size.
+std::vector<int> MarkerThread::rebuildObjectPoints()
+{
+    objPoints = makeObjectPoints(markerSize);
+
+    // Resolve marker size per id, default size applies where configuration has none
+    std::map<int, float> idSizes;
+    std::vector<int> conflictingIds;
+    for (const auto &config : configurations) {
+        float size = config.second.markerSize > 0.0f ? config.second.markerSize : markerSize;
+        for (int id : config.second.markerIds) {
+            auto it = idSizes.find(id);
+            if (it == idSizes.end()) {
+                idSizes.emplace(id, size);
+            } else if (it->second != size
+                       && std::find(conflictingIds.begin(), conflictingIds.end(), id)
+                              == conflictingIds.end()) {
+                conflictingIds.push_back(id);
+            }
+        }
+    }
+    for (int id : conflictingIds) {
+        idSizes.erase(id);
+    }
+
+    std::map<float, cv::Mat> pointsBySize;
+    markerObjPoints.clear();
+    for (const auto &idSize : idSizes) {
+        if (idSize.second == markerSize) {
+            continue;
+        }
+        auto it = pointsBySize.find(idSize.second);
+        if (it == pointsBySize.end()) {
+            it = pointsBySize.emplace(idSize.second, makeObjectPoints(idSize.second)).first;
+        }
+        markerObjPoints[idSize.first] = it->second;
+    }
+
+    // setMarkerSize may be called on every step of a spin box, report each conflict only once
+    if (conflictingIds == markerSizeConflicts) {
+        return {};
+    }
+    markerSizeConflicts = conflictingIds;
+    return conflictingIds;
+}
+
+void MarkerThread::reportMarkerSizeConflicts(const std::vector<int> &conflictingIds)
+{
+    if (conflictingIds.empty()) {
+        return;
+    }
+
+    QStringList ids;
+    for (int id : conflictingIds) {
+        ids << QString::number(id);
+    }
+    qWarning() << "Conflicting marker sizes for marker ids" << ids;
+    emit taskFinished(
+        false,
+        tr("Markers %1 have different sizes in different configurations, default size is used.")
+            .arg(ids.join(", ")));
+}
+
+const cv::Mat &MarkerThread::getObjectPoints(int markerId) const
+{
+    auto it = markerObjPoints.find(markerId);
+    return it != markerObjPoints.end() ? it->second : objPoints;
 }
 
 void MarkerThread::detectCurrentConfiguration()
@@ -182,47 +291,24 @@ void MarkerThread::updateCenterPointPosition()
         return;
     }
     const auto &config = currentConfiguration;
-    std::vector<cv::Point3f> allPoints;
-    std::vector<float> reprojectionErrors;
+    blockRotations.clear();
+    blockTvecs.clear();
+    blockRelativePoints.clear();
 
     for (int id : config.markerIds) {
         auto it = std::find(markerIds.begin(), markerIds.end(), id);
         if (it != markerIds.end()) {
             int index = std::distance(markerIds.begin(), it);
 
-            cv::Mat rotationMatrix;
-            cv::Rodrigues(rvecs.at(index), rotationMatrix);
-
-            cv::Mat relativePointMat
-                = (cv::Mat_<double>(3, 1) << config.relativePoints.at(id).x,
-                   config.relativePoints.at(id).y,
-                   config.relativePoints.at(id).z);
-            cv::Mat newPointMat = rotationMatrix * relativePointMat + cv::Mat(tvecs.at(index));
-
-            float error = cv::norm(relativePointMat - newPointMat);
-
-            allPoints.push_back(cv::Point3f(
-                newPointMat.at<double>(0), newPointMat.at<double>(1), newPointMat.at<double>(2)));
-            reprojectionErrors.push_back(error);
+            const cv::Point3f &relativePoint = config.relativePoints.at(id);
+            blockRotations.push_back(rotations[index]);
+            blockTvecs.push_back(tvecs[index]);
+            blockRelativePoints.push_back(
+                cv::Vec3d(relativePoint.x, relativePoint.y, relativePoint.z));
         }
     }
 
-    if (!allPoints.empty()) {
-        centerPoint = calculateWeightedAveragePoint(allPoints, reprojectionErrors);
+    if (!blockRelativePoints.empty()) {
+        centerPoint = blockCenter(blockRotations, blockTvecs, blockRelativePoints);
     }
 }
-
-cv::Point3f MarkerThread::calculateWeightedAveragePoint(
-    const std::vector<cv::Point3f> &points, const std::vector<float> &errors)
-{
-    cv::Point3f weightedSum(0, 0, 0);
-    float totalWeight = 0.0f;
-
-    for (size_t i = 0; i < points.size(); i++) {
-        float weight = 1.0f / (errors[i] + 1e-5);
-        weightedSum += points[i] * weight;
-        totalWeight += weight;
-    }
-
-    return weightedSum / totalWeight;
-}
@@ -9,6 +9,8 @@
 #include <QPointF>
 #include <QThread>
 
+class DetectionPublisher;
+
 // Class containing information about marker block
 class MarkerBlock
 {
@@ -27,8 +29,9 @@ public:
 
     void setYamlHandler(YamlHandler *handler) { yamlHandler = handler; }
     void setCalibrationParams(const CalibrationParams &params) { calibrationParams = params; }
-    void setMarkerSize(float newSize) { markerSize = newSize; }
+    void setMarkerSize(float newSize);
     void setBlockDetectionStatus(bool status) { blockDetectionStatus = status; }
+    void setPublisher(DetectionPublisher *newPublisher);
 
     Configuration getCurrConfiguration() { return currentConfiguration; }
     bool getBlockDetectionStatus() { return blockDetectionStatus; }
@@ -45,11 +48,12 @@ protected:
     void run() override;
 
 public slots:
-    void setMarkerSize(int size) { markerSize = (float) size; }
+    void setMarkerSize(int size) { setMarkerSize((float) size); }
     void updateConfigurationsMap();
 
 private:
     YamlHandler *yamlHandler;
+    DetectionPublisher *publisher;
     QMutex mutex;
     bool running;
     bool blockDetectionStatus;
@@ -61,7 +65,9 @@ private:
     cv::aruco::Dictionary AruCoDict;
     cv::aruco::DetectorParameters detectorParams;
     cv::aruco::ArucoDetector detector;
-    cv::Mat objPoints;
+    cv::Mat objPoints;                       // Object points for markers of default size
+    std::map<int, cv::Mat> markerObjPoints; // Object points for markers with configured size
+    std::vector<int> markerSizeConflicts;   // Last reported ids with conflicting sizes
 
     Configuration currentConfiguration;
     std::map<std::string, Configuration> configurations;
@@ -70,15 +76,23 @@ private:
     std::vector<int> markerIds;
     std::vector<cv::Vec3d> rvecs;
     std::vector<cv::Vec3d> tvecs;
+    std::vector<cv::Matx33d> rotations; // Rotation matrices matching rvecs
+    std::vector<float> yaws;            // Yaw angles of markers in degrees
     std::vector<std::pair<cv::Point2f, cv::Point3f>> markerPoints;
 
     cv::Point3f centerPoint;
 
+    // Per-frame scratch buffers, kept as members to reuse their capacity
+    std::vector<cv::Matx33d> blockRotations;
+    std::vector<cv::Vec3d> blockTvecs;
+    std::vector<cv::Vec3d> blockRelativePoints;
+
     void detectCurrentConfiguration();
+    std::vector<int> rebuildObjectPoints();
+    void reportMarkerSizeConflicts(const std::vector<int> &conflictingIds);
+    const cv::Mat &getObjectPoints(int markerId) const;
 
     void updateCenterPointPosition();
-    cv::Point3f calculateWeightedAveragePoint(
-        const std::vector<cv::Point3f> &points, const std::vector<float> &errors);
 };
 
 #endif // MARKERTHREAD_H
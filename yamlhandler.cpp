@@ -45,6 +45,7 @@ bool YamlHandler::loadConfigurations(
             configNode["Type"] >> config.type;
             configNode["Date"] >> config.date;
             configNode["MarkerIds"] >> config.markerIds;
+            configNode["MarkerSize"] >> config.markerSize;
             cv::FileNode relativePointsNode = configNode["RelativePoints"];
             for (const auto &relativePointNode : relativePointsNode) {
                 int markerId = std::stoi(relativePointNode.name().substr(7));
@@ -89,6 +90,9 @@ bool YamlHandler::saveConfigurations(
             fs << id;
         }
         fs << "]";
+        if (config.second.markerSize > 0.0f) {
+            fs << "MarkerSize" << config.second.markerSize;
+        }
         fs << "RelativePoints"
            << "{";
         for (const auto &relativePoint : config.second.relativePoints) {
@@ -12,6 +12,7 @@ struct Configuration
     std::string date;
     std::vector<int> markerIds;
     std::map<int, cv::Point3f> relativePoints;
+    float markerSize = 0.0f; // Marker side length, 0 means default size is used
 
     void clear()
     {
@@ -21,6 +22,7 @@ struct Configuration
         date = "";
         markerIds.clear();
         relativePoints.clear();
+        markerSize = 0.0f;
     }
 };
 